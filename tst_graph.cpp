@@ -1,11 +1,26 @@
 #include <stdexcept>
 #include <unordered_set>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
 
 //Qt
 #include <QString>
 #include <QtTest>
 #include <QTemporaryDir>
 #include <QCryptographicHash>
+#include <QElapsedTimer>
 
 //LIB
 #include <easylogging++.h>
@@ -145,6 +160,26 @@ private Q_SLOTS:
     void testMappingEngineConditionalFlowEdge();
     void testExecutionEngineConditionalFlowEdge();
 
+    void benchmarkConditionalFlowEdgePaths_data();
+    void benchmarkConditionalFlowEdgePaths();
+
+    void scalingPathManagerGetFlows_data();
+    void scalingPathManagerGetFlows();
+    void scalingMemoryPathManagerGetFlows_data();
+    void scalingMemoryPathManagerGetFlows();
+    void scalingFlowGenerator_data();
+    void scalingFlowGenerator();
+    void scalingMemoryFlowGenerator_data();
+    void scalingMemoryFlowGenerator();
+    void scalingMappingEngine_data();
+    void scalingMappingEngine();
+    void scalingMemoryMappingEngine_data();
+    void scalingMemoryMappingEngine();
+    void scalingAnalizeFlows_data();
+    void scalingAnalizeFlows();
+    void scalingMemoryAnalizeFlows_data();
+    void scalingMemoryAnalizeFlows();
+
     void cleanupTestCase();
     void cleanup();
 
@@ -161,7 +196,49 @@ private:
      ExecutableMachineGraph* makeEvoprogMachine(int communications,
                                                 std::unique_ptr<CommandSender> exec,
                                                 std::unique_ptr<CommandSender> test);
-
+     ExecutableMachineGraph* makeSwitchBankMachine(int banks,
+                                                   int communications,
+                                                   std::unique_ptr<CommandSender> exec,
+                                                   std::unique_ptr<CommandSender> test);
+
+     ExecutableMachineGraph* makeLadderMachine(int columns,
+                                               int communications,
+                                               std::unique_ptr<CommandSender> exec,
+                                               std::unique_ptr<CommandSender> test);
+     ExecutableMachineGraph* makeTreeMachine(int depth,
+                                             int communications,
+                                             std::unique_ptr<CommandSender> exec,
+                                             std::unique_ptr<CommandSender> test);
+     MachineGraph* makeSwitchBankSketch(int banks);
+     MachineGraph* makeLadderSketch(int columns);
+     MachineGraph* makeTreeSketch(int depth);
+     ProtocolGraph* makeFlowChainsProtocol(int chains);
+     ExecutableMachineGraph* makeGeneratedMachine(const QString & topology, int containers);
+     MachineGraph* makeGeneratedSketch(const QString & topology);
+     std::shared_ptr<ProtocolGraph> makeGeneratedProtocol(const QString & protocolName, int containers);
+     void makeEvoprogPlugins(int communications,
+                             std::shared_ptr<Control> & control,
+                             std::shared_ptr<Extractor> & extractor,
+                             std::shared_ptr<Injector> & injector);
+     void addGeneratedTopologyRows();
+     void addFlowGeneratorRows();
+     void addGeneratedProtocolRows();
+     int treeDepth(int containers);
+     size_t countGeneratedFlows(PathManager & manager, const QString & topology, int containers);
+     size_t spectedGeneratedFlows(const QString & topology, int containers);
+     void fillChainGenerator(FlowGenerator<Edge> & generator, int edges);
+     std::string makeChainFlowText(int first, int edges);
+     std::string checkDistinctMapping(MappingEngine & map, MachineGraph* sketch);
+     std::string checkAnalizedFlows(ExecutionEngine & engine, const std::unordered_set<std::string> & expectedFlows);
+     std::unordered_set<std::string> makeCleaningExpectedFlows();
+     std::unordered_set<std::string> makeGeneratedProtocolFlows(const QString & protocolName, int containers);
+     qint64 residentMemory();
+     void setMemoryResult(qint64 memoryBefore);
+
+     static const int switchBankSize = 6;
+     static const int switchBankMediaFlows = 10;
+     static const int flowChainSize = 5;
+     static const int analizeFlowsIterations = 10;
 };
 
 GraphTest::GraphTest()
@@ -180,6 +257,13 @@ void GraphTest::initTestCase() {
 
 void GraphTest::init() {
     //PythonEnvironment::GetInstance()->initEnvironment();
+
+    //the scaling suite builds machines of up to 1000 containers, only on demand
+    if (QString(QTest::currentTestFunction()).startsWith("scaling") &&
+            !qEnvironmentVariableIsSet("EVOCODER_SCALING_BENCHMARKS"))
+    {
+        QSKIP("scaling suite disabled, set EVOCODER_SCALING_BENCHMARKS to run it");
+    }
 }
 
 void GraphTest::cleanupTestCase() {
@@ -793,25 +877,7 @@ void GraphTest::testProtocolFlowAnanlisys() {
             setStr.insert(str);
         }
 
-        std::unordered_set<std::string> expectedFlows = {std::string("6->10:6->1;1->8;8->10;") ,
-                std::string("6->10:6->2;2->8;8->10;") ,
-                std::string("3->10:3->1;1->8;8->10;") ,
-                std::string("3->10:3->2;2->8;8->10;") ,
-                std::string("7->10:7->1;1->8;8->10;") ,
-                std::string("7->10:7->2;2->8;8->10;") ,
-                std::string("6->9:6->2;2->8;8->9;") ,
-                std::string("3->9:3->2;2->8;8->9;") ,
-                std::string("7->9:7->2;2->8;8->9;") ,
-                std::string("6->9:6->1;1->9;") ,
-                std::string("3->9:3->1;1->9;") ,
-                std::string("7->9:7->1;1->9;") ,
-                std::string("6->9:6->2;2->9;") ,
-                std::string("3->9:3->2;2->9;") ,
-                std::string("7->9:7->2;2->9;") ,
-                std::string("0->10:0->1;1->8;8->10;") ,
-                std::string("4->10:4->1;1->8;8->10;") ,
-                std::string("0->10:0->2;2->8;8->10;") ,
-                std::string("5->10:5->2;2->8;8->10;")};
+        std::unordered_set<std::string> expectedFlows = makeCleaningExpectedFlows();
 
         for (string expF: expectedFlows) {
             auto it = setStr.find(expF);
@@ -923,6 +989,324 @@ void GraphTest::testExecutionEngineConditionalFlowEdge() {
     }
 }
 
+void GraphTest::benchmarkConditionalFlowEdgePaths_data() {
+    QTest::addColumn<int>("banks");
+
+    QTest::newRow("100 conditional edges") << 25;
+    QTest::newRow("200 conditional edges") << 50;
+    QTest::newRow("400 conditional edges") << 100;
+}
+
+void GraphTest::benchmarkConditionalFlowEdgePaths() {
+    QFETCH(int, banks);
+    try {
+        std::shared_ptr<ExecutableMachineGraph> machine(makeGeneratedMachine("banks", banks * switchBankSize));
+        PathManager manager(machine);
+        std::shared_ptr<ContainerNodeType> sinkType = make_shared<ContainerNodeType>(MovementType::irrelevant, ContainerType::sink);
+
+        //bank 0: media 0, chemo1 1, chemo2 2, cell 3, waste 4, cleaning 5,
+        //searching from chemo1 and chemo2 leaves media->chemoX out of the path so
+        //chemoX->cleaning must be rejected there
+
+        std::vector<int> sources = {0, 1, 2};
+        std::vector<std::vector<std::string>> spectedFlows = {{"0->1:0->1;",
+                                                               "0->3:0->1;1->3;",
+                                                               "0->4:0->1;1->3;3->4;",
+                                                               "0->4:0->1;1->4;",
+                                                               "0->5:0->1;1->5;",
+                                                               "0->2:0->2;",
+                                                               "0->3:0->2;2->3;",
+                                                               "0->5:0->2;2->3;3->5;",
+                                                               "0->4:0->2;2->4;",
+                                                               "0->5:0->2;2->5;"},
+                                                              {"1->3:1->3;",
+                                                               "1->4:1->3;3->4;",
+                                                               "1->4:1->4;"},
+                                                              {"2->3:2->3;",
+                                                               "2->5:2->3;3->5;",
+                                                               "2->4:2->4;"}};
+        //cell->waste needs chemo1->cell, cell->cleaning needs chemo2->cell,
+        //chemo1->cleaning needs media->chemo1 and chemo2->cleaning needs media->chemo2
+        std::vector<std::vector<std::string>> forbiddenFlows = {{"0->4:0->2;2->3;3->4;",
+                                                                 "0->5:0->1;1->3;3->5;"},
+                                                                {"1->5:1->5;",
+                                                                 "1->5:1->3;3->5;"},
+                                                                {"2->5:2->5;",
+                                                                 "2->4:2->3;3->4;"}};
+
+        size_t spectedBankFlows = 0;
+        for (size_t i = 0; i < sources.size(); i++) {
+            std::vector<std::string> calculated;
+            shared_ptr<SearcherIterator> it = manager.getFlows(sources[i], sinkType);
+            while (it->hasNext()) {
+                calculated.push_back(it->next()->toText());
+            }
+
+            QVERIFY2(calculated.size() == spectedFlows[i].size(), std::string(" path found size from " + patch::to_string(sources[i]) +
+                                                                              " are incongruent, expected: " +
+                                                                              patch::to_string(spectedFlows[i].size()) +
+                                                                              ", calculated: " +
+                                                                              patch::to_string(calculated.size())).c_str());
+
+            for (std::string spected: spectedFlows[i]) {
+                bool finded = std::find(calculated.begin(), calculated.end(), spected) != calculated.end();
+                QVERIFY2(finded, std::string(spected + std::string(", not found in bank 0 paths")).c_str());
+            }
+
+            for (std::string forbidden: forbiddenFlows[i]) {
+                bool finded = std::find(calculated.begin(), calculated.end(), forbidden) != calculated.end();
+                QVERIFY2(!finded, std::string(forbidden + std::string(", found in bank 0 paths but its conditional edge is not used")).c_str());
+            }
+            spectedBankFlows += spectedFlows[i].size();
+        }
+
+        //every bank is identical so every bank must contribute the same flows...
+        for (int bank = 1; bank < banks; bank++) {
+            for (size_t i = 0; i < sources.size(); i++) {
+                size_t sourceFlows = 0;
+                shared_ptr<SearcherIterator> it = manager.getFlows(bank * switchBankSize + sources[i], sinkType);
+                while (it->hasNext()) {
+                    it->next();
+                    sourceFlows++;
+                }
+                QVERIFY2(sourceFlows == spectedFlows[i].size(), std::string("bank " + patch::to_string(bank) +
+                                                                            " flows from " + patch::to_string(sources[i]) +
+                                                                            " are incongruent, calculated: " +
+                                                                            patch::to_string(sourceFlows)).c_str());
+            }
+        }
+
+        size_t flows = 0;
+        QBENCHMARK {
+            flows = 0;
+            for (int bank = 0; bank < banks; bank++) {
+                for (int source: sources) {
+                    shared_ptr<SearcherIterator> it = manager.getFlows(bank * switchBankSize + source, sinkType);
+                    while (it->hasNext()) {
+                        it->next();
+                        flows++;
+                    }
+                }
+            }
+        }
+        QVERIFY2(flows == banks * spectedBankFlows, std::string("flows found while benchmarking are incongruent, calculated: " +
+                                                                patch::to_string(flows)).c_str());
+    } catch (exception & e) {
+        QFAIL(std::string("exception thrown, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingPathManagerGetFlows_data() {
+    addGeneratedTopologyRows();
+}
+
+void GraphTest::scalingPathManagerGetFlows() {
+    QFETCH(QString, topology);
+    QFETCH(int, containers);
+    try {
+        std::shared_ptr<ExecutableMachineGraph> machine(makeGeneratedMachine(topology, containers));
+        PathManager manager(machine);
+
+        size_t flows = 0;
+        QBENCHMARK {
+            flows = countGeneratedFlows(manager, topology, containers);
+        }
+        size_t spected = spectedGeneratedFlows(topology, containers);
+        QVERIFY2(flows == spected, std::string(topology.toStdString() + ": path found size are incongruent, expected: " +
+                                               patch::to_string(spected) +
+                                               ", calculated: " +
+                                               patch::to_string(flows)).c_str());
+    } catch (exception & e) {
+        QFAIL(std::string("exception thrown, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingMemoryPathManagerGetFlows_data() {
+    addGeneratedTopologyRows();
+}
+
+void GraphTest::scalingMemoryPathManagerGetFlows() {
+    QFETCH(QString, topology);
+    QFETCH(int, containers);
+    try {
+        std::shared_ptr<ExecutableMachineGraph> machine(makeGeneratedMachine(topology, containers));
+        PathManager manager(machine);
+
+        qint64 memoryBefore = residentMemory();
+        if (memoryBefore < 0) {
+            QSKIP("resident memory is not available on this platform");
+        }
+        size_t flows = countGeneratedFlows(manager, topology, containers);
+        setMemoryResult(memoryBefore);
+
+        QVERIFY2(flows == spectedGeneratedFlows(topology, containers), std::string(topology.toStdString() + ": path found size are incongruent, calculated: " +
+                                                                                   patch::to_string(flows)).c_str());
+    } catch (exception & e) {
+        QFAIL(std::string("exception thrown, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingFlowGenerator_data() {
+    addFlowGeneratorRows();
+}
+
+void GraphTest::scalingFlowGenerator() {
+    QFETCH(int, edges);
+    try {
+        std::shared_ptr<Flow<Edge>> flow;
+        QBENCHMARK {
+            FlowGenerator<Edge> generator;
+            fillChainGenerator(generator, edges);
+            flow = generator.makePossibleFlowsBacktraking();
+        }
+        std::string spected = makeChainFlowText(0, edges);
+        QVERIFY2(flow->toText().compare(spected) == 0,
+                 std::string("flow is not correct, calculated: " + flow->toText() + ", expected: " + spected).c_str());
+    } catch (std::exception & e) {
+        QFAIL(std::string("exeception while executing, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingMemoryFlowGenerator_data() {
+    addFlowGeneratorRows();
+}
+
+void GraphTest::scalingMemoryFlowGenerator() {
+    QFETCH(int, edges);
+    try {
+        qint64 memoryBefore = residentMemory();
+        if (memoryBefore < 0) {
+            QSKIP("resident memory is not available on this platform");
+        }
+        FlowGenerator<Edge> generator;
+        fillChainGenerator(generator, edges);
+        std::shared_ptr<Flow<Edge>> flow = generator.makePossibleFlowsBacktraking();
+        setMemoryResult(memoryBefore);
+
+        std::string spected = makeChainFlowText(0, edges);
+        QVERIFY2(flow->toText().compare(spected) == 0,
+                 std::string("flow is not correct, calculated: " + flow->toText() + ", expected: " + spected).c_str());
+    } catch (std::exception & e) {
+        QFAIL(std::string("exeception while executing, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingMappingEngine_data() {
+    addGeneratedTopologyRows();
+}
+
+void GraphTest::scalingMappingEngine() {
+    QFETCH(QString, topology);
+    QFETCH(int, containers);
+    try {
+        std::shared_ptr<ExecutableMachineGraph> machine(makeGeneratedMachine(topology, containers));
+        std::shared_ptr<MachineGraph> sketch(makeGeneratedSketch(topology));
+
+        MappingEngine::FlowSet emptySet;
+        MappingEngine checkMap(sketch.get(), machine);
+        QVERIFY2(checkMap.startMapping(emptySet), std::string(topology.toStdString() + ": mapping cannot be done").c_str());
+        std::string error = checkDistinctMapping(checkMap, sketch.get());
+        QVERIFY2(error.empty(), std::string(topology.toStdString() + ": " + error).c_str());
+
+        bool mapped = false;
+        QBENCHMARK {
+            MappingEngine map(sketch.get(), machine);
+            mapped = map.startMapping(emptySet);
+        }
+        QVERIFY2(mapped, std::string(topology.toStdString() + ": mapping cannot be done").c_str());
+    } catch (exception & e) {
+        QFAIL(std::string("exception while executing test, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingMemoryMappingEngine_data() {
+    addGeneratedTopologyRows();
+}
+
+void GraphTest::scalingMemoryMappingEngine() {
+    QFETCH(QString, topology);
+    QFETCH(int, containers);
+    try {
+        std::shared_ptr<ExecutableMachineGraph> machine(makeGeneratedMachine(topology, containers));
+        std::shared_ptr<MachineGraph> sketch(makeGeneratedSketch(topology));
+        MappingEngine::FlowSet emptySet;
+
+        qint64 memoryBefore = residentMemory();
+        if (memoryBefore < 0) {
+            QSKIP("resident memory is not available on this platform");
+        }
+        MappingEngine map(sketch.get(), machine);
+        bool mapped = map.startMapping(emptySet);
+        setMemoryResult(memoryBefore);
+
+        QVERIFY2(mapped, std::string(topology.toStdString() + ": mapping cannot be done").c_str());
+        std::string error = checkDistinctMapping(map, sketch.get());
+        QVERIFY2(error.empty(), std::string(topology.toStdString() + ": " + error).c_str());
+    } catch (exception & e) {
+        QFAIL(std::string("exception while executing test, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingAnalizeFlows_data() {
+    addGeneratedProtocolRows();
+}
+
+void GraphTest::scalingAnalizeFlows() {
+    QFETCH(QString, protocolName);
+    QFETCH(int, containers);
+    try {
+        string machineRef = ExecutionMachineServer::GetInstance()->addNewMachine("exMachine.json");
+        std::unordered_set<std::string> expectedFlows = makeGeneratedProtocolFlows(protocolName, containers);
+
+        //QBENCHMARK cannot leave the setup out, so every iteration gets its own protocol and an engine
+        //that is not registered in the ExecutionServer, only sketcher and analizeFlows are timed
+        qint64 elapsed = 0;
+        for (int i = 0; i < analizeFlowsIterations; i++) {
+            std::shared_ptr<ProtocolGraph> protocol = makeGeneratedProtocol(protocolName, containers);
+            ExecutionEngine engine(protocol, machineRef);
+
+            QElapsedTimer timer;
+            timer.start();
+            engine.sketcher();
+            engine.analizeFlows();
+            elapsed += timer.nsecsElapsed();
+
+            std::string error = checkAnalizedFlows(engine, expectedFlows);
+            QVERIFY2(error.empty(), std::string(protocolName.toStdString() + ": " + error).c_str());
+        }
+        QTest::setBenchmarkResult(elapsed / analizeFlowsIterations, QTest::WalltimeNanoseconds);
+    } catch (std::exception & e) {
+        QFAIL(std::string("exeception while executing, " + std::string(e.what())).c_str());
+    }
+}
+
+void GraphTest::scalingMemoryAnalizeFlows_data() {
+    addGeneratedProtocolRows();
+}
+
+void GraphTest::scalingMemoryAnalizeFlows() {
+    QFETCH(QString, protocolName);
+    QFETCH(int, containers);
+    try {
+        string machineRef = ExecutionMachineServer::GetInstance()->addNewMachine("exMachine.json");
+        std::shared_ptr<ProtocolGraph> protocol = makeGeneratedProtocol(protocolName, containers);
+        ExecutionEngine engine(protocol, machineRef);
+
+        qint64 memoryBefore = residentMemory();
+        if (memoryBefore < 0) {
+            QSKIP("resident memory is not available on this platform");
+        }
+        engine.sketcher();
+        engine.analizeFlows();
+        setMemoryResult(memoryBefore);
+
+        std::string error = checkAnalizedFlows(engine, makeGeneratedProtocolFlows(protocolName, containers));
+        QVERIFY2(error.empty(), std::string(protocolName.toStdString() + ": " + error).c_str());
+    } catch (std::exception & e) {
+        QFAIL(std::string("exeception while executing, " + std::string(e.what())).c_str());
+    }
+}
+
 MachineGraph* GraphTest::makeTurbidostatSketch() {
     MachineGraph* sketch = new MachineGraph("sketchTurbidostat");
 
@@ -1135,6 +1519,480 @@ ExecutableMachineGraph* GraphTest::makeEvoprogMachine(int communications,
     return machine;
 }
 
+ExecutableMachineGraph* GraphTest::makeSwitchBankMachine(int banks,
+                                                         int communications,
+                                                         std::unique_ptr<CommandSender> exec,
+                                                         std::unique_ptr<CommandSender> test)
+{
+    ExecutableMachineGraph* machine = new ExecutableMachineGraph(
+                "switchBankMachine", std::move(exec), std::move(test));
+
+    std::shared_ptr<Control> control;
+    std::shared_ptr<Extractor> cExtractor;
+    std::shared_ptr<Injector> dummyInjector;
+    makeEvoprogPlugins(communications, control, cExtractor, dummyInjector);
+
+    //every bank is a reduced evoprog: media, chemo1, chemo2, cell, waste and cleaning,
+    //with 4 conditional edges each
+    ConditionalFlowEdge::AllowedEdgeSet allAllowed;
+    for (int bank = 0; bank < banks; bank++) {
+        int media = bank * switchBankSize;
+        int chemo1 = media + 1;
+        int chemo2 = media + 2;
+        int cell = media + 3;
+        int waste = media + 4;
+        int cleaning = media + 5;
+
+        machine->addContainer(std::make_shared<InletContainer>(media, 100.0, cExtractor));
+        machine->addContainer(std::make_shared<BidirectionalSwitch>(chemo1, 100.0, cExtractor, dummyInjector, control, control));
+        machine->addContainer(std::make_shared<BidirectionalSwitch>(chemo2, 100.0, cExtractor, dummyInjector, control, control));
+        machine->addContainer(std::make_shared<BidirectionalSwitch>(cell, 100.0, cExtractor, dummyInjector, control, control));
+        machine->addContainer(std::make_shared<ConvergentSwitch>(waste, 100.0, dummyInjector, control));
+        machine->addContainer(std::make_shared<ConvergentSwitch>(cleaning, 100.0, dummyInjector, control));
+
+        machine->connectExecutableContainer(media, chemo1, allAllowed);
+        machine->connectExecutableContainer(media, chemo2, allAllowed);
+        machine->connectExecutableContainer(chemo1, cell, allAllowed);
+        machine->connectExecutableContainer(chemo2, cell, allAllowed);
+        machine->connectExecutableContainer(chemo1, waste, allAllowed);
+        machine->connectExecutableContainer(chemo2, waste, allAllowed);
+
+        ConditionalFlowEdge::AllowedEdgeSet onlyChemo1Cell;
+        onlyChemo1Cell.insert(machine->getEdge(chemo1, cell));
+        machine->connectExecutableContainer(cell, waste, onlyChemo1Cell);
+
+        ConditionalFlowEdge::AllowedEdgeSet onlyChemo2Cell;
+        onlyChemo2Cell.insert(machine->getEdge(chemo2, cell));
+        machine->connectExecutableContainer(cell, cleaning, onlyChemo2Cell);
+
+        ConditionalFlowEdge::AllowedEdgeSet onlyMediaChemo1;
+        onlyMediaChemo1.insert(machine->getEdge(media, chemo1));
+        machine->connectExecutableContainer(chemo1, cleaning, onlyMediaChemo1);
+
+        ConditionalFlowEdge::AllowedEdgeSet onlyMediaChemo2;
+        onlyMediaChemo2.insert(machine->getEdge(media, chemo2));
+        machine->connectExecutableContainer(chemo2, cleaning, onlyMediaChemo2);
+    }
+
+    return machine;
+}
+
+ExecutableMachineGraph* GraphTest::makeLadderMachine(int columns,
+                                                     int communications,
+                                                     std::unique_ptr<CommandSender> exec,
+                                                     std::unique_ptr<CommandSender> test)
+{
+    ExecutableMachineGraph* machine = new ExecutableMachineGraph(
+                "ladderMachine", std::move(exec), std::move(test));
+
+    std::shared_ptr<Control> control;
+    std::shared_ptr<Extractor> cExtractor;
+    std::shared_ptr<Injector> dummyInjector;
+    makeEvoprogPlugins(communications, control, cExtractor, dummyInjector);
+
+    //two rows of columns containers, top row 0..columns-1 and bottom row columns..2*columns-1,
+    //inlet at the top left, sink at the bottom right, liquid moves right and down
+    int last = 2 * columns - 1;
+    for (int id = 0; id <= last; id++) {
+        if (id == 0) {
+            machine->addContainer(std::make_shared<InletContainer>(id, 100.0, cExtractor));
+        } else if (id == last) {
+            machine->addContainer(std::make_shared<ConvergentSwitch>(id, 100.0, dummyInjector, control));
+        } else {
+            machine->addContainer(std::make_shared<BidirectionalSwitch>(id, 100.0, cExtractor, dummyInjector, control, control));
+        }
+    }
+
+    ConditionalFlowEdge::AllowedEdgeSet allAllowed;
+    for (int column = 0; column < columns; column++) {
+        if (column + 1 < columns) {
+            machine->connectExecutableContainer(column, column + 1, allAllowed);
+            machine->connectExecutableContainer(columns + column, columns + column + 1, allAllowed);
+        }
+        machine->connectExecutableContainer(column, columns + column, allAllowed);
+    }
+
+    return machine;
+}
+
+ExecutableMachineGraph* GraphTest::makeTreeMachine(int depth,
+                                                   int communications,
+                                                   std::unique_ptr<CommandSender> exec,
+                                                   std::unique_ptr<CommandSender> test)
+{
+    ExecutableMachineGraph* machine = new ExecutableMachineGraph(
+                "treeMachine", std::move(exec), std::move(test));
+
+    std::shared_ptr<Control> control;
+    std::shared_ptr<Extractor> cExtractor;
+    std::shared_ptr<Injector> dummyInjector;
+    makeEvoprogPlugins(communications, control, cExtractor, dummyInjector);
+
+    //binary tree in heap order, children of i are 2i+1 and 2i+2
+    int containers = (1 << (depth + 1)) - 1;
+    int firstLeaf = (1 << depth) - 1;
+    for (int id = 0; id < containers; id++) {
+        if (id == 0) {
+            machine->addContainer(std::make_shared<DivergentSwitch>(id, 100.0, cExtractor, control));
+        } else if (id >= firstLeaf) {
+            machine->addContainer(std::make_shared<ConvergentSwitch>(id, 100.0, dummyInjector, control));
+        } else {
+            machine->addContainer(std::make_shared<BidirectionalSwitch>(id, 100.0, cExtractor, dummyInjector, control, control));
+        }
+    }
+
+    ConditionalFlowEdge::AllowedEdgeSet allAllowed;
+    for (int id = 0; id < firstLeaf; id++) {
+        machine->connectExecutableContainer(id, 2 * id + 1, allAllowed);
+        machine->connectExecutableContainer(id, 2 * id + 2, allAllowed);
+    }
+
+    return machine;
+}
+
+ExecutableMachineGraph* GraphTest::makeGeneratedMachine(const QString & topology, int containers) {
+    std::unique_ptr<CommandSender> comEx(new SerialSender("\\\\.\\COM3"));
+    std::unique_ptr<CommandSender> comTest(new FileSender("test.log", "inputFileData.txt"));
+    int com = CommunicationsInterface::GetInstance()->addCommandSender(comEx->clone());
+
+    if (topology == "ladder") {
+        return makeLadderMachine(containers / 2, com, std::move(comEx), std::move(comTest));
+    } else if (topology == "tree") {
+        return makeTreeMachine(treeDepth(containers), com, std::move(comEx), std::move(comTest));
+    } else if (topology == "banks") {
+        return makeSwitchBankMachine(containers / switchBankSize, com, std::move(comEx), std::move(comTest));
+    }
+    throw std::invalid_argument("unknown topology " + topology.toStdString());
+}
+
+MachineGraph* GraphTest::makeGeneratedSketch(const QString & topology) {
+    //always the smallest instance of the same topology, so only the machine grows
+    if (topology == "ladder") {
+        return makeLadderSketch(2);
+    } else if (topology == "tree") {
+        return makeTreeSketch(1);
+    } else if (topology == "banks") {
+        return makeSwitchBankSketch(1);
+    }
+    throw std::invalid_argument("unknown topology " + topology.toStdString());
+}
+
+std::shared_ptr<ProtocolGraph> GraphTest::makeGeneratedProtocol(const QString & protocolName, int containers) {
+    if (protocolName == "cleaning") {
+        BioBlocksJSONReader reader("BioBlocksCleaning.json", 200000);
+        return reader.getProtocol();
+    } else if (protocolName == "chains") {
+        return std::shared_ptr<ProtocolGraph>(makeFlowChainsProtocol(containers / flowChainSize));
+    }
+    throw std::invalid_argument("unknown protocol " + protocolName.toStdString());
+}
+
+void GraphTest::makeEvoprogPlugins(int communications,
+                                   std::shared_ptr<Control> & control,
+                                   std::shared_ptr<Extractor> & extractor,
+                                   std::shared_ptr<Injector> & injector)
+{
+    std::unordered_map<std::string, std::string> paramsc = {{"address","46"},
+                                                            {"closePos","0"}};
+    control.reset(new ControlPlugin(communications,"v1", "Evoprog4WayValve", paramsc));
+
+    std::unordered_map<std::string, std::string> paramse = {{"address","7"},
+                                                            {"direction","0"}};
+    extractor.reset(new ExtractorPlugin(communications,"p1", "EvoprogV2Pump", paramse));
+
+    std::unordered_map<std::string, std::string> paramsi;
+    injector.reset(new InjectorPlugin(communications, "dummy", "EvoprogDummyInjector", paramsi));
+}
+
+void GraphTest::addGeneratedTopologyRows() {
+    QTest::addColumn<QString>("topology");
+    QTest::addColumn<int>("containers");
+
+    QTest::newRow("ladder 10") << QString("ladder") << 10;
+    QTest::newRow("ladder 100") << QString("ladder") << 100;
+    QTest::newRow("ladder 1000") << QString("ladder") << 1000;
+    QTest::newRow("tree 7") << QString("tree") << 7;
+    QTest::newRow("tree 127") << QString("tree") << 127;
+    QTest::newRow("tree 1023") << QString("tree") << 1023;
+    QTest::newRow("banks 12") << QString("banks") << 12;
+    QTest::newRow("banks 102") << QString("banks") << 102;
+    QTest::newRow("banks 1002") << QString("banks") << 1002;
+}
+
+void GraphTest::addFlowGeneratorRows() {
+    QTest::addColumn<int>("edges");
+
+    QTest::newRow("10 edges") << 10;
+    QTest::newRow("100 edges") << 100;
+    QTest::newRow("1000 edges") << 1000;
+}
+
+void GraphTest::addGeneratedProtocolRows() {
+    QTest::addColumn<QString>("protocolName");
+    QTest::addColumn<int>("containers");
+
+    QTest::newRow("cleaning") << QString("cleaning") << 0;
+    QTest::newRow("chains 10") << QString("chains") << 10;
+    QTest::newRow("chains 100") << QString("chains") << 100;
+    QTest::newRow("chains 1000") << QString("chains") << 1000;
+}
+
+int GraphTest::treeDepth(int containers) {
+    //deepest complete binary tree that fits in containers
+    int depth = 0;
+    while ((1 << (depth + 2)) - 1 <= containers) {
+        depth++;
+    }
+    return depth;
+}
+
+size_t GraphTest::countGeneratedFlows(PathManager & manager, const QString & topology, int containers) {
+    std::shared_ptr<ContainerNodeType> sinkType = make_shared<ContainerNodeType>(MovementType::irrelevant, ContainerType::sink);
+
+    size_t flows = 0;
+    shared_ptr<SearcherIterator> it;
+    if (topology == "ladder") {
+        it = manager.getFlows(0, 2 * (containers / 2) - 1);
+        while (it->hasNext()) {
+            it->next();
+            flows++;
+        }
+    } else if (topology == "tree") {
+        it = manager.getFlows(0, sinkType);
+        while (it->hasNext()) {
+            it->next();
+            flows++;
+        }
+    } else {
+        for (int media = 0; media + switchBankSize <= containers; media += switchBankSize) {
+            it = manager.getFlows(media, sinkType);
+            while (it->hasNext()) {
+                it->next();
+                flows++;
+            }
+        }
+    }
+    return flows;
+}
+
+size_t GraphTest::spectedGeneratedFlows(const QString & topology, int containers) {
+    if (topology == "ladder") {
+        //one path for every rung taken from the top row to the bottom row
+        return containers / 2;
+    } else if (topology == "tree") {
+        //one path from the root to every other container
+        return (1 << (treeDepth(containers) + 1)) - 2;
+    }
+    //see the flows from media in benchmarkConditionalFlowEdgePaths
+    return (containers / switchBankSize) * switchBankMediaFlows;
+}
+
+void GraphTest::fillChainGenerator(FlowGenerator<Edge> & generator, int edges) {
+    //even edges first and odd edges later, so the generator must reorder them
+    for (int i = 0; i < edges; i += 2) {
+        generator.addEdge(std::make_shared<Edge>(i, i + 1));
+    }
+    for (int i = 1; i < edges; i += 2) {
+        generator.addEdge(std::make_shared<Edge>(i, i + 1));
+    }
+}
+
+std::string GraphTest::makeChainFlowText(int first, int edges) {
+    std::string flow = patch::to_string(first) + "->" + patch::to_string(first + edges) + ":";
+    for (int id = first; id < first + edges; id++) {
+        flow += patch::to_string(id) + "->" + patch::to_string(id + 1) + ";";
+    }
+    return flow;
+}
+
+std::string GraphTest::checkDistinctMapping(MappingEngine & map, MachineGraph* sketch) {
+    std::unordered_set<int> usedNodes;
+    std::unordered_set<std::string> usedEdges;
+
+    MachineGraph::ContainerNodeVector nodes(*sketch->getGraph()->getAllNodes().get());
+    for (MachineGraph::ContainerNodePtr node: nodes) {
+        int mappedNode = map.getMappedContainerId(node->getContainerId());
+        if (usedNodes.find(mappedNode) == usedNodes.end()) {
+            usedNodes.insert(mappedNode);
+        } else {
+            return "node " + patch::to_string(node->getContainerId()) +
+                    " is mapped to a execution node that mapped before, " + patch::to_string(mappedNode);
+        }
+    }
+
+    MachineGraph::ContainerEdgeVector edges(*sketch->getGraph()->getEdgeList().get());
+    for (MachineGraph::ContainerEdgePtr edge: edges) {
+        ExecutableMachineGraph::FlowType* flow = map.getMappedEdge(edge);
+        if (usedEdges.find(flow->toText()) == usedEdges.end()) {
+            usedEdges.insert(flow->toText());
+        } else {
+            return "edge " + edge->toText() + " is mapped to an used edge " + flow->toText();
+        }
+    }
+    return "";
+}
+
+std::string GraphTest::checkAnalizedFlows(ExecutionEngine & engine, const std::unordered_set<std::string> & expectedFlows) {
+    unordered_set<std::string> setStr;
+    for (std::shared_ptr<Flow<Edge>> flow: engine.getFlowSet()) {
+        setStr.insert(flow->toText());
+    }
+    for (string expF: expectedFlows) {
+        if (setStr.find(expF) == setStr.end()) {
+            return "missing flow: " + expF;
+        }
+    }
+    return "";
+}
+
+qint64 GraphTest::residentMemory() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+#else
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long residentPages = 0;
+    if (statm >> pages >> residentPages) {
+        return static_cast<qint64>(residentPages) * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+void GraphTest::setMemoryResult(qint64 memoryBefore) {
+    //growth of the resident set over one run of the workload, the fixture is already built
+    QTest::setBenchmarkResult(qMax<qint64>(0, residentMemory() - memoryBefore), QTest::BytesAllocated);
+}
+
+std::unordered_set<std::string> GraphTest::makeCleaningExpectedFlows() {
+    std::unordered_set<std::string> expectedFlows = {std::string("6->10:6->1;1->8;8->10;") ,
+                                                     std::string("6->10:6->2;2->8;8->10;") ,
+                                                     std::string("3->10:3->1;1->8;8->10;") ,
+                                                     std::string("3->10:3->2;2->8;8->10;") ,
+                                                     std::string("7->10:7->1;1->8;8->10;") ,
+                                                     std::string("7->10:7->2;2->8;8->10;") ,
+                                                     std::string("6->9:6->2;2->8;8->9;") ,
+                                                     std::string("3->9:3->2;2->8;8->9;") ,
+                                                     std::string("7->9:7->2;2->8;8->9;") ,
+                                                     std::string("6->9:6->1;1->9;") ,
+                                                     std::string("3->9:3->1;1->9;") ,
+                                                     std::string("7->9:7->1;1->9;") ,
+                                                     std::string("6->9:6->2;2->9;") ,
+                                                     std::string("3->9:3->2;2->9;") ,
+                                                     std::string("7->9:7->2;2->9;") ,
+                                                     std::string("0->10:0->1;1->8;8->10;") ,
+                                                     std::string("4->10:4->1;1->8;8->10;") ,
+                                                     std::string("0->10:0->2;2->8;8->10;") ,
+                                                     std::string("5->10:5->2;2->8;8->10;")};
+    return expectedFlows;
+}
+
+std::unordered_set<std::string> GraphTest::makeGeneratedProtocolFlows(const QString & protocolName, int containers) {
+    if (protocolName == "cleaning") {
+        return makeCleaningExpectedFlows();
+    }
+
+    std::unordered_set<std::string> expectedFlows;
+    for (int chain = 0; chain < containers / flowChainSize; chain++) {
+        expectedFlows.insert(makeChainFlowText(chain * flowChainSize, flowChainSize - 1));
+    }
+    return expectedFlows;
+}
+
+MachineGraph* GraphTest::makeSwitchBankSketch(int banks) {
+    MachineGraph* sketch = new MachineGraph("sketchSwitchBank");
+
+    std::shared_ptr<ContainerNodeType> inlet(new ContainerNodeType(MovementType::irrelevant, ContainerType::inlet));
+    std::shared_ptr<ContainerNodeType> convergentSwitch(new ContainerNodeType(MovementType::irrelevant, ContainerType::convergent_switch));
+    std::shared_ptr<ContainerNodeType> bidirectionalT(new ContainerNodeType(MovementType::continuous, ContainerType::bidirectional_switch));
+
+    for (int bank = 0; bank < banks; bank++) {
+        int media = bank * switchBankSize;
+        int chemo1 = media + 1;
+        int chemo2 = media + 2;
+        int cell = media + 3;
+        int waste = media + 4;
+        int cleaning = media + 5;
+
+        sketch->addContainer(media, inlet, 100.0);
+        sketch->addContainer(chemo1, bidirectionalT, 100.0);
+        sketch->addContainer(chemo2, bidirectionalT, 100.0);
+        sketch->addContainer(cell, bidirectionalT, 100.0);
+        sketch->addContainer(waste, convergentSwitch, 100.0);
+        sketch->addContainer(cleaning, convergentSwitch, 100.0);
+
+        sketch->connectContainer(media, chemo1);
+        sketch->connectContainer(media, chemo2);
+        sketch->connectContainer(chemo1, cell);
+        sketch->connectContainer(chemo2, cell);
+        sketch->connectContainer(chemo1, waste);
+        sketch->connectContainer(chemo2, waste);
+        sketch->connectContainer(cell, waste);
+        sketch->connectContainer(chemo1, cleaning);
+    }
+
+    return sketch;
+}
+
+MachineGraph* GraphTest::makeLadderSketch(int columns) {
+    MachineGraph* sketch = new MachineGraph("sketchLadder");
+
+    std::shared_ptr<ContainerNodeType> inlet(new ContainerNodeType(MovementType::irrelevant, ContainerType::inlet));
+    std::shared_ptr<ContainerNodeType> convergentSwitch(new ContainerNodeType(MovementType::irrelevant, ContainerType::convergent_switch));
+    std::shared_ptr<ContainerNodeType> bidirectionalT(new ContainerNodeType(MovementType::continuous, ContainerType::bidirectional_switch));
+
+    int last = 2 * columns - 1;
+    for (int id = 0; id <= last; id++) {
+        if (id == 0) {
+            sketch->addContainer(id, inlet, 100.0);
+        } else if (id == last) {
+            sketch->addContainer(id, convergentSwitch, 100.0);
+        } else {
+            sketch->addContainer(id, bidirectionalT, 100.0);
+        }
+    }
+
+    for (int column = 0; column < columns; column++) {
+        if (column + 1 < columns) {
+            sketch->connectContainer(column, column + 1);
+            sketch->connectContainer(columns + column, columns + column + 1);
+        }
+        sketch->connectContainer(column, columns + column);
+    }
+
+    return sketch;
+}
+
+MachineGraph* GraphTest::makeTreeSketch(int depth) {
+    MachineGraph* sketch = new MachineGraph("sketchTree");
+
+    std::shared_ptr<ContainerNodeType> convergentSwitch(new ContainerNodeType(MovementType::irrelevant, ContainerType::convergent_switch));
+    std::shared_ptr<ContainerNodeType> bidirectionalT(new ContainerNodeType(MovementType::continuous, ContainerType::bidirectional_switch));
+    std::shared_ptr<ContainerNodeType> divergentSwitch(new ContainerNodeType(MovementType::continuous, ContainerType::divergent_switch));
+
+    int containers = (1 << (depth + 1)) - 1;
+    int firstLeaf = (1 << depth) - 1;
+    for (int id = 0; id < containers; id++) {
+        if (id == 0) {
+            sketch->addContainer(id, divergentSwitch, 100.0);
+        } else if (id >= firstLeaf) {
+            sketch->addContainer(id, convergentSwitch, 100.0);
+        } else {
+            sketch->addContainer(id, bidirectionalT, 100.0);
+        }
+    }
+
+    for (int id = 0; id < firstLeaf; id++) {
+        sketch->connectContainer(id, 2 * id + 1);
+        sketch->connectContainer(id, 2 * id + 2);
+    }
+
+    return sketch;
+}
+
 MachineGraph* GraphTest::makeEvoprogSketch()  {
     MachineGraph* sketch = new MachineGraph("sketchTurbidostat");
 
@@ -1177,6 +2035,48 @@ MachineGraph* GraphTest::makeEvoprogSketch()  {
     return sketch;
 }
 
+ProtocolGraph* GraphTest::makeFlowChainsProtocol(int chains)
+{
+    AutoEnumerate serial;
+    ProtocolGraph* protocol = new ProtocolGraph("flowChainsProtocol");
+
+    std::shared_ptr<ComparisonOperable> tautology(new Tautology());
+    std::shared_ptr<MathematicOperable> num1(new ConstantNumber(0.001));
+    std::shared_ptr<MathematicOperable> num60000(new ConstantNumber(60000));
+
+    std::shared_ptr<VariableEntry> time(
+        new VariableEntry(TIME_VARIABLE));
+    std::shared_ptr<MathematicOperable> mtime(
+        new VariableEntry(TIME_VARIABLE));
+    std::shared_ptr<ComparisonOperable> comp2in(
+        new SimpleComparison(false, mtime, comparison::less_equal, num60000));
+    ProtocolGraph::ProtocolNodePtr loop1 = std::make_shared<LoopNode>(serial.getNextValue(), comp2in); //while ( t <= 60s)
+
+    protocol->addOperation(loop1);
+
+    //every chain moves liquid through flowChainSize containers: c -> c+1 -> ... -> c+flowChainSize-1
+    ProtocolGraph::ProtocolNodePtr last = loop1;
+    std::shared_ptr<ComparisonOperable> condition = comp2in;
+    for (int chain = 0; chain < chains; chain++) {
+        for (int id = chain * flowChainSize; id < (chain + 1) * flowChainSize - 1; id++) {
+            ProtocolGraph::ProtocolNodePtr op = std::make_shared<SetContinousFlow>(serial.getNextValue(), id, id + 1, num1);
+            protocol->addOperation(op);
+            protocol->connectOperation(last, op, condition);
+            last = op;
+            condition = tautology;
+        }
+    }
+
+    ProtocolGraph::ProtocolNodePtr timeStep = std::make_shared<TimeStep>(serial.getNextValue(), time);
+
+    protocol->addOperation(timeStep);
+    protocol->connectOperation(last, timeStep, condition);
+    protocol->connectOperation(timeStep, loop1, tautology);
+
+    protocol->setStartNode(loop1->getContainerId());
+    return protocol;
+}
+
 ProtocolGraph* GraphTest::makeTimeProtocol()
 {
 